@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "helper.hpp"
+#include "hooks.hpp"
 #include <inipp/inipp.h>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -34,26 +35,24 @@ bool bHideCursor;
 bool bUncapFPS;
 bool bShadowRes;
 int iShadowRes;
+bool bThreadScheduling;
+bool bPinGameThreads;
+int iFixThreadPriority = THREAD_PRIORITY_HIGHEST;
 
 // Aspect ratio + HUD stuff
-float fPi = (float)3.141592653;
 float fNativeAspect = (float)16 / 9;
-float fNativeWidth;
-float fNativeHeight;
-float fAspectRatio;
-float fAspectMultiplier;
-float fHUDWidth;
-float fHUDHeight;
+Hooks::AspectState Aspect = { fNativeAspect };
 float fDefaultHUDWidth = (float)1920;
 float fDefaultHUDHeight = (float)1080;
-float fHUDWidthOffset;
-float fHUDHeightOffset;
 
 // Variables
 int iResX;
 int iResY;
 float fCurrentFrametime;
 int iCreateWindowCount;
+KAFFINITY PerformanceCoreMask;
+std::vector<ULONG> PerformanceCpuSetIds;
+thread_local bool bGameThreadScheduled;
 
 // CreateWindowExW Hook
 SafetyHookInline CreateWindowExW_hook{};
@@ -172,6 +171,9 @@ void ReadConfig()
     inipp::get_value(ini.sections["Unlock Framerate"], "Enabled", bUncapFPS);
     inipp::get_value(ini.sections["Shadow Resolution"], "Enabled", bShadowRes);
     inipp::get_value(ini.sections["Shadow Resolution"], "Resolution", iShadowRes);
+    inipp::get_value(ini.sections["Threads"], "Enabled", bThreadScheduling);
+    inipp::get_value(ini.sections["Threads"], "PinGameThreads", bPinGameThreads);
+    inipp::get_value(ini.sections["Threads"], "FixThreadPriority", iFixThreadPriority);
 
     // Log config parse
     spdlog::info("Config Parse: bCustomResolution: {}", bCustomResolution);
@@ -191,6 +193,14 @@ void ReadConfig()
     spdlog::info("Config Parse: bUncapFPS: {}", bUncapFPS);
     spdlog::info("Config Parse: bShadowRes: {}", bShadowRes);
     spdlog::info("Config Parse: iShadowRes: {}", iShadowRes);
+    spdlog::info("Config Parse: bThreadScheduling: {}", bThreadScheduling);
+    spdlog::info("Config Parse: bPinGameThreads: {}", bPinGameThreads);
+    spdlog::info("Config Parse: iFixThreadPriority: {}", iFixThreadPriority);
+    if (iFixThreadPriority < THREAD_PRIORITY_LOWEST || iFixThreadPriority > THREAD_PRIORITY_HIGHEST)
+    {
+        iFixThreadPriority = THREAD_PRIORITY_HIGHEST;
+        spdlog::warn("Config Parse: iFixThreadPriority must be between -2 and 2, set to {}", iFixThreadPriority);
+    }
     spdlog::info("----------");
 
     // Get desktop resolution
@@ -206,6 +216,96 @@ void ReadConfig()
     }
 }
 
+void Threads()
+{
+    // Apply configured priority to our Main thread (DllMain starts it at THREAD_PRIORITY_HIGHEST)
+    if (!SetThreadPriority(GetCurrentThread(), iFixThreadPriority))
+    {
+        spdlog::error("Threads: Failed to set fix thread priority to {}.", iFixThreadPriority);
+    }
+
+    if (bThreadScheduling)
+    {
+        DWORD_PTR processAffinityMask = 0;
+        DWORD_PTR systemAffinityMask = 0;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &processAffinityMask, &systemAffinityMask))
+        {
+            spdlog::error("Threads: Failed to get process affinity mask.");
+            return;
+        }
+
+        // Only the process's primary processor group is supported.
+        // Our Main thread starts in it and GetProcessAffinityMask describes it.
+        GROUP_AFFINITY groupAffinity{};
+        if (!GetThreadGroupAffinity(GetCurrentThread(), &groupAffinity))
+        {
+            spdlog::error("Threads: Failed to get processor group.");
+            return;
+        }
+        spdlog::info("Threads: Processor group: {}", groupAffinity.Group);
+
+        auto cores = Scheduler::GetCoreTopology(groupAffinity.Group);
+        for (const auto& core : cores)
+        {
+            spdlog::info("Threads: Core: Mask: 0x{:x}, Efficiency Class: {}", core.mask, core.efficiencyClass);
+        }
+
+        PerformanceCoreMask = (KAFFINITY)Scheduler::SelectPerformanceCores(cores, processAffinityMask);
+        if (!PerformanceCoreMask)
+        {
+            spdlog::info("Threads: No hybrid CPU topology detected, leaving game threads unscheduled.");
+            return;
+        }
+        spdlog::info("Threads: Performance core mask: 0x{:x}", PerformanceCoreMask);
+
+        if (!bPinGameThreads)
+        {
+            // Soft preference for the whole set of performance cores
+            auto cpuSetIds = Scheduler::SelectCpuSets(Scheduler::GetCpuSets(groupAffinity.Group), PerformanceCoreMask);
+            PerformanceCpuSetIds.assign(cpuSetIds.begin(), cpuSetIds.end());
+            if (PerformanceCpuSetIds.empty())
+            {
+                spdlog::error("Threads: Failed to get CPU sets for performance cores, leaving game threads unscheduled.");
+                PerformanceCoreMask = 0;
+                return;
+            }
+            spdlog::info("Threads: Performance core CPU sets: {}", PerformanceCpuSetIds.size());
+        }
+    }
+}
+
+// Moves the game thread calling this on to performance cores, once per thread
+void ScheduleGameThread(const char* sThreadName)
+{
+    if (!PerformanceCoreMask || bGameThreadScheduled)
+        return;
+    bGameThreadScheduled = true;
+
+    DWORD dwThreadId = GetCurrentThreadId();
+    if (bPinGameThreads)
+    {
+        if (SetThreadAffinityMask(GetCurrentThread(), PerformanceCoreMask))
+        {
+            spdlog::info("Threads: Pinned {} thread ({}) to performance cores.", sThreadName, dwThreadId);
+        }
+        else
+        {
+            spdlog::error("Threads: Failed to pin {} thread ({}) to performance cores.", sThreadName, dwThreadId);
+        }
+    }
+    else
+    {
+        if (SetThreadSelectedCpuSets(GetCurrentThread(), PerformanceCpuSetIds.data(), (ULONG)PerformanceCpuSetIds.size()))
+        {
+            spdlog::info("Threads: Set {} thread ({}) to prefer performance cores.", sThreadName, dwThreadId);
+        }
+        else
+        {
+            spdlog::error("Threads: Failed to set {} thread ({}) to prefer performance cores.", sThreadName, dwThreadId);
+        }
+    }
+}
+
 void Resolution()
 {
     // Apply custom resolution
@@ -218,11 +318,8 @@ void Resolution()
         ApplyResolutionMidHook = safetyhook::create_mid(ApplyResolutionScanResult,
             [](SafetyHookContext& ctx)
             {
-                if (bCustomResolution)
-                {
-                    ctx.rbx = iCustomResX;
-                    ctx.rax = iCustomResY;
-                }
+                ScheduleGameThread("main");
+                Hooks::ApplyResolution(ctx, bCustomResolution, iCustomResX, iCustomResY);
 
                 if (ctx.rsi + 0xC)
                 {
@@ -232,36 +329,19 @@ void Resolution()
 
                 iResX = (int)ctx.rbx;
                 iResY = (int)ctx.rax;
-
-                fAspectRatio = (float)iResX / iResY;
-                fAspectMultiplier = fAspectRatio / fNativeAspect;
-                fNativeWidth = (float)iResY * fNativeAspect;
-                fNativeHeight = (float)iResX / fNativeAspect;
-
-                // HUD variables
-                fHUDWidth = (float)iResY * fNativeAspect;
-                fHUDHeight = (float)iResY;
-                fHUDWidthOffset = (float)(iResX - fHUDWidth) / 2;
-                fHUDHeightOffset = 0;
-                if (fAspectRatio < fNativeAspect)
-                {
-                    fHUDWidth = (float)iResX;
-                    fHUDHeight = (float)iResX / fNativeAspect;
-                    fHUDWidthOffset = 0;
-                    fHUDHeightOffset = (float)(iResY - fHUDHeight) / 2;
-                }
+                Aspect = Hooks::CalculateAspectRatio(iResX, iResY, fNativeAspect);
 
                 // Log aspect ratio stuff
                 spdlog::info("----------");
                 spdlog::info("Resolution: Resolution: {}x{}", iResX, iResY);
-                spdlog::info("Resolution: fAspectRatio: {}", fAspectRatio);
-                spdlog::info("Resolution: fAspectMultiplier: {}", fAspectMultiplier);
-                spdlog::info("Resolution: fNativeWidth: {}", fNativeWidth);
-                spdlog::info("Resolution: fNativeHeight: {}", fNativeHeight);
-                spdlog::info("Resolution: fHUDWidth: {}", fHUDWidth);
-                spdlog::info("Resolution: fHUDHeight: {}", fHUDHeight);
-                spdlog::info("Resolution: fHUDWidthOffset: {}", fHUDWidthOffset);
-                spdlog::info("Resolution: fHUDHeightOffset: {}", fHUDHeightOffset);
+                spdlog::info("Resolution: fAspectRatio: {}", Aspect.fAspectRatio);
+                spdlog::info("Resolution: fAspectMultiplier: {}", Aspect.fAspectMultiplier);
+                spdlog::info("Resolution: fNativeWidth: {}", Aspect.fNativeWidth);
+                spdlog::info("Resolution: fNativeHeight: {}", Aspect.fNativeHeight);
+                spdlog::info("Resolution: fHUDWidth: {}", Aspect.fHUDWidth);
+                spdlog::info("Resolution: fHUDHeight: {}", Aspect.fHUDHeight);
+                spdlog::info("Resolution: fHUDWidthOffset: {}", Aspect.fHUDWidthOffset);
+                spdlog::info("Resolution: fHUDHeightOffset: {}", Aspect.fHUDHeightOffset);
                 spdlog::info("----------");
             });
     }
@@ -299,7 +379,7 @@ void AspectFOV()
                 {
                     if (ctx.rax + 0x280)
                     {
-                        *reinterpret_cast<float*>(ctx.rax + 0x280) = fAspectRatio;
+                        *reinterpret_cast<float*>(ctx.rax + 0x280) = Aspect.fAspectRatio;
                     }
                 });
         }
@@ -321,23 +401,15 @@ void AspectFOV()
             GameplayFOVMidHook = safetyhook::create_mid(GameplayFOVScanResult,
                 [](SafetyHookContext& ctx)
                 {
-                    if (fAspectRatio < fNativeAspect)
-                    {
-                        ctx.xmm8.f32[0] = atanf(tanf(ctx.xmm8.f32[0] * (fPi / 360)) / fAspectRatio * fNativeAspect) * (360 / fPi);
-                    }
-                }); 
+                    Hooks::ApplyGameplayFOV(ctx, Aspect);
+                });
 
             spdlog::info("Cutscene FOV: Address is {:s}+{:x}", sExeName.c_str(), (uintptr_t)CutsceneFOVScanResult - (uintptr_t)baseModule);
             static SafetyHookMid CutsceneFOVMidHook{};
             CutsceneFOVMidHook = safetyhook::create_mid(CutsceneFOVScanResult,
                 [](SafetyHookContext& ctx)
                 {
-                    if (fAspectRatio < fNativeAspect)
-                    {
-                        float fov = *reinterpret_cast<float*>(&ctx.rax);
-                        float newFov = atanf(tanf(fov * (fPi / 360)) / fAspectRatio * fNativeAspect) * (360 / fPi);
-                        ctx.rax = *(uint32_t*)&newFov;
-                    }
+                    Hooks::ApplyCutsceneFOV(ctx, Aspect);
                 });
         }
         else if (!GameplayFOVScanResult || !CutsceneFOVScanResult)
@@ -360,20 +432,7 @@ void HUD()
             HUDMidHook = safetyhook::create_mid(HUDScanResult,
                 [](SafetyHookContext& ctx)
                 {
-                    if (fAspectRatio > fNativeAspect)
-                    {
-                        float HUDWidth = ceilf((float)544 * fAspectRatio);
-                        float HUDWidthOffset = ceilf((HUDWidth - 960.00f) / 2.00f);
-                        ctx.xmm2.u32[0] = (int)ceilf(HUDWidth - HUDWidthOffset);
-                        ctx.xmm1.f32[0] = -HUDWidthOffset;
-                    }
-                    else if (fAspectRatio < fNativeAspect)
-                    {
-                        float HUDHeight = ceilf((float)960 / fAspectRatio);
-                        float HUDHeightOffset = ceilf((HUDHeight - 544.00f) / 2.00f);
-                        ctx.xmm0.f32[0] = ceilf(HUDHeight - HUDHeightOffset);
-                        ctx.xmm3.f32[0] = -HUDHeightOffset;
-                    }
+                    Hooks::ApplyHUD(ctx, Aspect);
                 });
         }
         else if (!HUDScanResult)
@@ -411,7 +470,8 @@ void Framerate()
             CurrentFrametimeMidHook = safetyhook::create_mid(CurrentFrametimeScanResult,
                 [](SafetyHookContext& ctx)
                 {
-                    fCurrentFrametime = ctx.xmm0.f32[0];
+                    ScheduleGameThread("frame");
+                    fCurrentFrametime = Hooks::GetCurrentFrametime(ctx);
                 });
 
             // Game speed (3D stuff)
@@ -420,7 +480,7 @@ void Framerate()
             GameSpeed1MidHook = safetyhook::create_mid(GameSpeed1ScanResult + 0x16,
                 [](SafetyHookContext& ctx)
                 {
-                    ctx.xmm0.f32[0] = 1000.0f / fCurrentFrametime;
+                    Hooks::ApplyGameSpeed1(ctx, fCurrentFrametime);
                 });
 
             // Game speed (animations?)
@@ -429,7 +489,7 @@ void Framerate()
             GameSpeed2MidHook = safetyhook::create_mid(GameSpeed2ScanResult,
                 [](SafetyHookContext& ctx)
                 {
-                    ctx.xmm0.f32[0] = (1000.0f / fCurrentFrametime) / 30.0f;
+                    Hooks::ApplyGameSpeed2(ctx, fCurrentFrametime);
                 });
         }
         else if (!FPSCapScanResult || !GameSpeed1ScanResult || !GameSpeed2ScanResult || !CurrentFrametimeScanResult)
@@ -471,6 +531,7 @@ DWORD __stdcall Main(void*)
 {
     Logging();
     ReadConfig();
+    Threads();
     Resolution();
     AspectFOV();
     HUD();
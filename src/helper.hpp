@@ -1,4 +1,5 @@
 #include "stdafx.h"
+#include "scheduler.hpp"
 #include <stdio.h>
 
 using namespace std;
@@ -136,4 +137,55 @@ namespace Util
 
         return {};
     }
-}
\ No newline at end of file
+}
+
+namespace Scheduler
+{
+    // Physical cores in the given processor group
+    std::vector<CoreInfo> GetCoreTopology(WORD group)
+    {
+        std::vector<CoreInfo> cores;
+
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+            return cores;
+
+        std::vector<std::uint8_t> buffer(length);
+        if (!GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.data(), &length))
+            return cores;
+
+        for (DWORD offset = 0; offset < length;)
+        {
+            auto info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer.data() + offset);
+            if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == group)
+                cores.push_back({ (uint64_t)info->Processor.GroupMask[0].Mask, info->Processor.EfficiencyClass });
+            offset += info->Size;
+        }
+        return cores;
+    }
+
+    // CPU sets in the given processor group
+    std::vector<CpuSetInfo> GetCpuSets(WORD group)
+    {
+        std::vector<CpuSetInfo> cpuSets;
+
+        ULONG length = 0;
+        GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+            return cpuSets;
+
+        std::vector<std::uint8_t> buffer(length);
+        if (!GetSystemCpuSetInformation((PSYSTEM_CPU_SET_INFORMATION)buffer.data(), length, &length, GetCurrentProcess(), 0))
+            return cpuSets;
+
+        for (ULONG offset = 0; offset < length;)
+        {
+            auto info = (PSYSTEM_CPU_SET_INFORMATION)(buffer.data() + offset);
+            if (info->Type == CpuSetInformation && info->CpuSet.Group == group)
+                cpuSets.push_back({ (uint32_t)info->CpuSet.Id, info->CpuSet.LogicalProcessorIndex });
+            offset += info->Size;
+        }
+        return cpuSets;
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Register handling for the mid-hooks. Kept free of Windows/spdlog/safetyhook so it can be built and tested on the host.
+// Context is SafetyHookContext in the game, or any struct with the same register members.
+namespace Hooks
+{
+    constexpr float fPi = (float)3.141592653;
+
+    struct AspectState
+    {
+        float fNativeAspect;
+        float fAspectRatio;
+        float fAspectMultiplier;
+        float fNativeWidth;
+        float fNativeHeight;
+        float fHUDWidth;
+        float fHUDHeight;
+        float fHUDWidthOffset;
+        float fHUDHeightOffset;
+    };
+
+    inline AspectState CalculateAspectRatio(int iResX, int iResY, float fNativeAspect)
+    {
+        AspectState aspect{};
+        aspect.fNativeAspect = fNativeAspect;
+        aspect.fAspectRatio = (float)iResX / iResY;
+        aspect.fAspectMultiplier = aspect.fAspectRatio / fNativeAspect;
+        aspect.fNativeWidth = (float)iResY * fNativeAspect;
+        aspect.fNativeHeight = (float)iResX / fNativeAspect;
+
+        // HUD variables
+        aspect.fHUDWidth = (float)iResY * fNativeAspect;
+        aspect.fHUDHeight = (float)iResY;
+        aspect.fHUDWidthOffset = (float)(iResX - aspect.fHUDWidth) / 2;
+        aspect.fHUDHeightOffset = 0;
+        if (aspect.fAspectRatio < fNativeAspect)
+        {
+            aspect.fHUDWidth = (float)iResX;
+            aspect.fHUDHeight = (float)iResX / fNativeAspect;
+            aspect.fHUDWidthOffset = 0;
+            aspect.fHUDHeightOffset = (float)(iResY - aspect.fHUDHeight) / 2;
+        }
+        return aspect;
+    }
+
+    // Width in rbx, height in rax
+    template<typename Context>
+    void ApplyResolution(Context& ctx, bool bCustomResolution, int iCustomResX, int iCustomResY)
+    {
+        if (bCustomResolution)
+        {
+            ctx.rbx = iCustomResX;
+            ctx.rax = iCustomResY;
+        }
+    }
+
+    inline float CorrectFOV(float fov, const AspectState& aspect)
+    {
+        return atanf(tanf(fov * (fPi / 360)) / aspect.fAspectRatio * aspect.fNativeAspect) * (360 / fPi);
+    }
+
+    // Gameplay FOV in xmm8
+    template<typename Context>
+    void ApplyGameplayFOV(Context& ctx, const AspectState& aspect)
+    {
+        if (aspect.fAspectRatio < aspect.fNativeAspect)
+        {
+            ctx.xmm8.f32[0] = CorrectFOV(ctx.xmm8.f32[0], aspect);
+        }
+    }
+
+    // Cutscene FOV as float bits in the low dword of rax
+    template<typename Context>
+    void ApplyCutsceneFOV(Context& ctx, const AspectState& aspect)
+    {
+        if (aspect.fAspectRatio < aspect.fNativeAspect)
+        {
+            uint32_t fovBits = (uint32_t)ctx.rax;
+            float fov;
+            memcpy(&fov, &fovBits, sizeof(fov));
+            float newFov = CorrectFOV(fov, aspect);
+            memcpy(&fovBits, &newFov, sizeof(newFov));
+            ctx.rax = fovBits;
+        }
+    }
+
+    // HUD is laid out at 960x544. Wider: width in xmm2 (int), x offset in xmm1. Narrower: height in xmm0, y offset in xmm3.
+    template<typename Context>
+    void ApplyHUD(Context& ctx, const AspectState& aspect)
+    {
+        if (aspect.fAspectRatio > aspect.fNativeAspect)
+        {
+            float HUDWidth = ceilf((float)544 * aspect.fAspectRatio);
+            float HUDWidthOffset = ceilf((HUDWidth - 960.00f) / 2.00f);
+            ctx.xmm2.u32[0] = (int)ceilf(HUDWidth - HUDWidthOffset);
+            ctx.xmm1.f32[0] = -HUDWidthOffset;
+        }
+        else if (aspect.fAspectRatio < aspect.fNativeAspect)
+        {
+            float HUDHeight = ceilf((float)960 / aspect.fAspectRatio);
+            float HUDHeightOffset = ceilf((HUDHeight - 544.00f) / 2.00f);
+            ctx.xmm0.f32[0] = ceilf(HUDHeight - HUDHeightOffset);
+            ctx.xmm3.f32[0] = -HUDHeightOffset;
+        }
+    }
+
+    // Current frametime (ms) in xmm0
+    template<typename Context>
+    float GetCurrentFrametime(const Context& ctx)
+    {
+        return ctx.xmm0.f32[0];
+    }
+
+    // Game speed (3D stuff) in xmm0
+    template<typename Context>
+    void ApplyGameSpeed1(Context& ctx, float fCurrentFrametime)
+    {
+        ctx.xmm0.f32[0] = 1000.0f / fCurrentFrametime;
+    }
+
+    // Game speed (animations?) in xmm0, relative to 30fps
+    template<typename Context>
+    void ApplyGameSpeed2(Context& ctx, float fCurrentFrametime)
+    {
+        ctx.xmm0.f32[0] = (1000.0f / fCurrentFrametime) / 30.0f;
+    }
+}
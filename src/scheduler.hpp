@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// CPU topology selection for the [Threads] section. Kept free of Windows so it can be tested with fake topologies.
+// Masks are logical processor masks within a single processor group (KAFFINITY on x64).
+namespace Scheduler
+{
+    // One physical core; SMT siblings share a core, so mask can have more than one bit set
+    struct CoreInfo
+    {
+        uint64_t mask;
+        uint8_t efficiencyClass;
+    };
+
+    // One CPU set (one logical processor) as reported by GetSystemCpuSetInformation
+    struct CpuSetInfo
+    {
+        uint32_t id;
+        uint8_t logicalProcessorIndex;
+    };
+
+    // Logical processors belonging to cores of the given efficiency class, limited to allowedMask
+    inline uint64_t SelectCores(const std::vector<CoreInfo>& cores, uint8_t efficiencyClass, uint64_t allowedMask)
+    {
+        uint64_t mask = 0;
+        for (const auto& core : cores)
+        {
+            if (core.efficiencyClass == efficiencyClass)
+                mask |= core.mask;
+        }
+        return mask & allowedMask;
+    }
+
+    // Performance cores have the highest efficiency class. Returns 0 if the CPU isn't hybrid or none are allowed.
+    inline uint64_t SelectPerformanceCores(const std::vector<CoreInfo>& cores, uint64_t allowedMask)
+    {
+        if (cores.empty())
+            return 0;
+
+        uint8_t highestClass = cores[0].efficiencyClass;
+        uint8_t lowestClass = cores[0].efficiencyClass;
+        for (const auto& core : cores)
+        {
+            if (core.efficiencyClass > highestClass)
+                highestClass = core.efficiencyClass;
+            if (core.efficiencyClass < lowestClass)
+                lowestClass = core.efficiencyClass;
+        }
+
+        if (highestClass == lowestClass)
+            return 0;
+
+        return SelectCores(cores, highestClass, allowedMask);
+    }
+
+    // IDs of the CPU sets whose logical processor is in mask
+    inline std::vector<uint32_t> SelectCpuSets(const std::vector<CpuSetInfo>& cpuSets, uint64_t mask)
+    {
+        std::vector<uint32_t> ids;
+        for (const auto& cpuSet : cpuSets)
+        {
+            if (cpuSet.logicalProcessorIndex < 64 && (mask & ((uint64_t)1 << cpuSet.logicalProcessorIndex)))
+                ids.push_back(cpuSet.id);
+        }
+        return ids;
+    }
+}
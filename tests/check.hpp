@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+inline int iFailures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            iFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        double actualValue = (actual); \
+        double expectedValue = (expected); \
+        if (std::fabs(actualValue - expectedValue) > (tolerance)) { \
+            std::printf("%s:%d: CHECK_NEAR failed: %s = %f, expected %f\n", __FILE__, __LINE__, #actual, actualValue, expectedValue); \
+            iFailures++; \
+        } \
+    } while (0)
@@ -0,0 +1,111 @@
+#include "hooks.hpp"
+#include "test_context.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    constexpr float fNativeAspect = (float)16 / 9;
+    constexpr int iIterations = 10000000;
+
+    template<typename T>
+    void DoNotOptimize(T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        volatile auto sink = &value;
+        (void)sink;
+#endif
+    }
+
+    // Runs hook(ctx, i) iIterations times and prints the average ns/call
+    template<typename Fn>
+    void Bench(const char* sName, Fn hook)
+    {
+        TestContext ctx;
+        memset(&ctx, 0, sizeof(ctx));
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iIterations; i++)
+        {
+            hook(ctx, i);
+            DoNotOptimize(ctx);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("%-20s %8.2f ns/call\n", sName, ns / iIterations);
+    }
+}
+
+int main()
+{
+    // Cycle through 16:9, 21:9, 32:9, 4:3 and 16:10 so every branch is exercised
+    const Hooks::AspectState aspects[] = {
+        Hooks::CalculateAspectRatio(1920, 1080, fNativeAspect),
+        Hooks::CalculateAspectRatio(3440, 1440, fNativeAspect),
+        Hooks::CalculateAspectRatio(5120, 1440, fNativeAspect),
+        Hooks::CalculateAspectRatio(1600, 1200, fNativeAspect),
+        Hooks::CalculateAspectRatio(1920, 1200, fNativeAspect),
+    };
+    const size_t aspectCount = std::size(aspects);
+
+    // Recorded-style 60fps frametimes with hitches
+    const float frametimes[] = { 16.6f, 16.7f, 16.5f, 50.0f, 16.6f, 8.3f, 8.4f, 8.3f, 100.0f, 16.7f };
+    const size_t frametimeCount = std::size(frametimes);
+
+    Bench("ApplyResolution", [](TestContext& ctx, int i)
+        {
+            ctx.rbx = 1280;
+            ctx.rax = 720;
+            Hooks::ApplyResolution(ctx, i & 1, 3440, 1440);
+        });
+
+    Bench("CalculateAspectRatio", [](TestContext& ctx, int i)
+        {
+            auto aspect = Hooks::CalculateAspectRatio(1600 + (i & 0xFF), 1200, fNativeAspect);
+            ctx.xmm0.f32[0] = aspect.fHUDHeightOffset;
+        });
+
+    Bench("ApplyGameplayFOV", [&](TestContext& ctx, int i)
+        {
+            ctx.xmm8.f32[0] = 60.0f;
+            Hooks::ApplyGameplayFOV(ctx, aspects[i % aspectCount]);
+        });
+
+    Bench("ApplyCutsceneFOV", [&](TestContext& ctx, int i)
+        {
+            float fov = 45.0f;
+            uint32_t bits;
+            memcpy(&bits, &fov, sizeof(bits));
+            ctx.rax = bits;
+            Hooks::ApplyCutsceneFOV(ctx, aspects[i % aspectCount]);
+        });
+
+    Bench("ApplyHUD", [&](TestContext& ctx, int i)
+        {
+            Hooks::ApplyHUD(ctx, aspects[i % aspectCount]);
+        });
+
+    Bench("GetCurrentFrametime", [&](TestContext& ctx, int i)
+        {
+            ctx.xmm0.f32[0] = frametimes[i % frametimeCount];
+            ctx.xmm1.f32[0] = Hooks::GetCurrentFrametime(ctx);
+        });
+
+    Bench("ApplyGameSpeed1", [&](TestContext& ctx, int i)
+        {
+            Hooks::ApplyGameSpeed1(ctx, frametimes[i % frametimeCount]);
+        });
+
+    Bench("ApplyGameSpeed2", [&](TestContext& ctx, int i)
+        {
+            Hooks::ApplyGameSpeed2(ctx, frametimes[i % frametimeCount]);
+        });
+
+    return 0;
+}
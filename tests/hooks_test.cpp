@@ -0,0 +1,274 @@
+#include "hooks.hpp"
+#include "check.hpp"
+#include "test_context.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    constexpr float fNativeAspect = (float)16 / 9;
+    constexpr uintptr_t Sentinel = 0xDEADBEEFDEADBEEF;
+
+    TestContext MakeContext()
+    {
+        TestContext ctx;
+        memset(&ctx, 0xCD, sizeof(ctx));
+        return ctx;
+    }
+
+    uint32_t Bits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float FromBits(uintptr_t value)
+    {
+        uint32_t bits = (uint32_t)value;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    struct ResolutionCase
+    {
+        const char* sName;
+        int iResX;
+        int iResY;
+    };
+
+    void TestCalculateAspectRatio()
+    {
+        // 16:9
+        auto aspect = Hooks::CalculateAspectRatio(1920, 1080, fNativeAspect);
+        CHECK_NEAR(aspect.fAspectRatio, 16.0 / 9.0, 1e-5);
+        CHECK_NEAR(aspect.fAspectMultiplier, 1.0, 1e-5);
+        CHECK_NEAR(aspect.fHUDWidth, 1920, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeight, 1080, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidthOffset, 0, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeightOffset, 0, 1e-2);
+
+        // 21:9, HUD pillarboxed
+        aspect = Hooks::CalculateAspectRatio(2560, 1080, fNativeAspect);
+        CHECK_NEAR(aspect.fAspectRatio, 2560.0 / 1080.0, 1e-5);
+        CHECK_NEAR(aspect.fAspectMultiplier, (2560.0 / 1080.0) / (16.0 / 9.0), 1e-5);
+        CHECK_NEAR(aspect.fNativeWidth, 1920, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidth, 1920, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeight, 1080, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidthOffset, 320, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeightOffset, 0, 1e-2);
+
+        // 32:9, HUD pillarboxed
+        aspect = Hooks::CalculateAspectRatio(5120, 1440, fNativeAspect);
+        CHECK_NEAR(aspect.fHUDWidth, 2560, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidthOffset, 1280, 1e-2);
+
+        // 4:3, HUD letterboxed
+        aspect = Hooks::CalculateAspectRatio(1600, 1200, fNativeAspect);
+        CHECK_NEAR(aspect.fNativeHeight, 900, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidth, 1600, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeight, 900, 1e-2);
+        CHECK_NEAR(aspect.fHUDWidthOffset, 0, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeightOffset, 150, 1e-2);
+
+        // 16:10, HUD letterboxed
+        aspect = Hooks::CalculateAspectRatio(1920, 1200, fNativeAspect);
+        CHECK_NEAR(aspect.fHUDWidth, 1920, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeight, 1080, 1e-2);
+        CHECK_NEAR(aspect.fHUDHeightOffset, 60, 1e-2);
+    }
+
+    void TestApplyResolution()
+    {
+        auto ctx = MakeContext();
+        ctx.rbx = 1280;
+        ctx.rax = 720;
+        Hooks::ApplyResolution(ctx, true, 3440, 1440);
+        CHECK(ctx.rbx == 3440);
+        CHECK(ctx.rax == 1440);
+
+        ctx.rbx = 1280;
+        ctx.rax = 720;
+        Hooks::ApplyResolution(ctx, false, 3440, 1440);
+        CHECK(ctx.rbx == 1280);
+        CHECK(ctx.rax == 720);
+    }
+
+    void TestFOV()
+    {
+        const ResolutionCase unchanged[] = {
+            { "16:9", 1920, 1080 },
+            { "21:9", 2560, 1080 },
+            { "21:9", 3440, 1440 },
+            { "32:9", 5120, 1440 },
+        };
+
+        // FOV is only corrected when narrower than 16:9
+        for (const auto& res : unchanged)
+        {
+            auto aspect = Hooks::CalculateAspectRatio(res.iResX, res.iResY, fNativeAspect);
+
+            auto ctx = MakeContext();
+            ctx.xmm8.f32[0] = 60.0f;
+            Hooks::ApplyGameplayFOV(ctx, aspect);
+            CHECK(ctx.xmm8.f32[0] == 60.0f);
+
+            ctx.rax = Bits(45.0f);
+            Hooks::ApplyCutsceneFOV(ctx, aspect);
+            CHECK(ctx.rax == Bits(45.0f));
+        }
+
+        // 4:3
+        auto aspect = Hooks::CalculateAspectRatio(1600, 1200, fNativeAspect);
+        auto ctx = MakeContext();
+        ctx.xmm8.f32[0] = 60.0f;
+        ctx.xmm8.f32[1] = 1.0f;
+        Hooks::ApplyGameplayFOV(ctx, aspect);
+        CHECK_NEAR(ctx.xmm8.f32[0], 75.178179, 1e-3);
+        CHECK(ctx.xmm8.f32[1] == 1.0f);
+
+        ctx.rax = Sentinel;
+        ctx.rax = (ctx.rax & ~(uintptr_t)0xFFFFFFFF) | Bits(45.0f);
+        Hooks::ApplyCutsceneFOV(ctx, aspect);
+        CHECK_NEAR(FromBits(ctx.rax), 57.822402, 1e-3);
+        CHECK((ctx.rax >> 32) == 0);
+
+        // 16:10
+        aspect = Hooks::CalculateAspectRatio(1920, 1200, fNativeAspect);
+        ctx = MakeContext();
+        ctx.xmm8.f32[0] = 60.0f;
+        Hooks::ApplyGameplayFOV(ctx, aspect);
+        CHECK_NEAR(ctx.xmm8.f32[0], 65.360368, 1e-3);
+
+        ctx.rax = Bits(45.0f);
+        Hooks::ApplyCutsceneFOV(ctx, aspect);
+        CHECK_NEAR(FromBits(ctx.rax), 49.427301, 1e-3);
+    }
+
+    void TestHUD()
+    {
+        // 16:9 leaves all registers alone
+        {
+            auto aspect = Hooks::CalculateAspectRatio(1920, 1080, fNativeAspect);
+            auto ctx = MakeContext();
+            auto before = ctx;
+            Hooks::ApplyHUD(ctx, aspect);
+            CHECK(memcmp(&ctx, &before, sizeof(ctx)) == 0);
+        }
+
+        struct WideCase
+        {
+            ResolutionCase res;
+            uint32_t iWidth;
+            float fOffset;
+        };
+
+        // Wider than 16:9: width in xmm2 (int), x offset in xmm1, xmm0/xmm3 untouched
+        const WideCase wide[] = {
+            { { "21:9", 2560, 1080 }, 1125, -165.0f },
+            { { "21:9", 3440, 1440 }, 1130, -170.0f },
+            { { "32:9", 5120, 1440 }, 1447, -488.0f },
+        };
+        for (const auto& test : wide)
+        {
+            auto aspect = Hooks::CalculateAspectRatio(test.res.iResX, test.res.iResY, fNativeAspect);
+            auto ctx = MakeContext();
+            auto before = ctx;
+            Hooks::ApplyHUD(ctx, aspect);
+            CHECK(ctx.xmm2.u32[0] == test.iWidth);
+            CHECK(ctx.xmm1.f32[0] == test.fOffset);
+            CHECK(memcmp(&ctx.xmm0, &before.xmm0, sizeof(ctx.xmm0)) == 0);
+            CHECK(memcmp(&ctx.xmm3, &before.xmm3, sizeof(ctx.xmm3)) == 0);
+        }
+
+        struct NarrowCase
+        {
+            ResolutionCase res;
+            float fHeight;
+            float fOffset;
+        };
+
+        // Narrower than 16:9: height in xmm0, y offset in xmm3, xmm1/xmm2 untouched
+        const NarrowCase narrow[] = {
+            { { "4:3", 1600, 1200 }, 632.0f, -88.0f },
+            { { "4:3", 1024, 768 }, 632.0f, -88.0f },
+            { { "16:10", 1920, 1200 }, 572.0f, -28.0f },
+            { { "16:10", 2560, 1600 }, 572.0f, -28.0f },
+        };
+        for (const auto& test : narrow)
+        {
+            auto aspect = Hooks::CalculateAspectRatio(test.res.iResX, test.res.iResY, fNativeAspect);
+            auto ctx = MakeContext();
+            auto before = ctx;
+            Hooks::ApplyHUD(ctx, aspect);
+            CHECK(ctx.xmm0.f32[0] == test.fHeight);
+            CHECK(ctx.xmm3.f32[0] == test.fOffset);
+            CHECK(memcmp(&ctx.xmm1, &before.xmm1, sizeof(ctx.xmm1)) == 0);
+            CHECK(memcmp(&ctx.xmm2, &before.xmm2, sizeof(ctx.xmm2)) == 0);
+        }
+    }
+
+    void TestFramerate()
+    {
+        // Frametimes in ms: steady 30/60/144fps and a 60fps run with hitches and a 120fps burst
+        const float frametimes30[] = { 33.333f, 33.334f, 33.333f, 33.333f, 33.334f };
+        const float frametimes60[] = { 16.667f, 16.666f, 16.667f, 16.667f, 16.666f };
+        const float frametimes144[] = { 6.944f, 6.945f, 6.944f, 6.944f, 6.945f };
+        const float frametimesHitch[] = { 16.6f, 16.7f, 16.5f, 50.0f, 16.6f, 8.3f, 8.4f, 8.3f, 100.0f, 16.7f };
+
+        struct Sequence
+        {
+            const float* frametimes;
+            size_t count;
+        };
+        const Sequence sequences[] = {
+            { frametimes30, std::size(frametimes30) },
+            { frametimes60, std::size(frametimes60) },
+            { frametimes144, std::size(frametimes144) },
+            { frametimesHitch, std::size(frametimesHitch) },
+        };
+
+        for (const auto& sequence : sequences)
+        {
+            for (size_t i = 0; i < sequence.count; i++)
+            {
+                auto ctx = MakeContext();
+                ctx.xmm0.f32[0] = sequence.frametimes[i];
+                float fCurrentFrametime = Hooks::GetCurrentFrametime(ctx);
+                CHECK(fCurrentFrametime == sequence.frametimes[i]);
+
+                ctx = MakeContext();
+                Hooks::ApplyGameSpeed1(ctx, fCurrentFrametime);
+                CHECK_NEAR(ctx.xmm0.f32[0], 1000.0 / sequence.frametimes[i], 1e-2);
+
+                ctx = MakeContext();
+                Hooks::ApplyGameSpeed2(ctx, fCurrentFrametime);
+                CHECK_NEAR(ctx.xmm0.f32[0], (1000.0 / sequence.frametimes[i]) / 30.0, 1e-4);
+            }
+        }
+
+        // 30fps is the game's native speed
+        auto ctx = MakeContext();
+        Hooks::ApplyGameSpeed2(ctx, 1000.0f / 30.0f);
+        CHECK_NEAR(ctx.xmm0.f32[0], 1.0, 1e-5);
+    }
+}
+
+int main()
+{
+    TestCalculateAspectRatio();
+    TestApplyResolution();
+    TestFOV();
+    TestHUD();
+    TestFramerate();
+
+    if (iFailures)
+    {
+        std::printf("%d check(s) failed.\n", iFailures);
+        return 1;
+    }
+    std::printf("All hook checks passed.\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "scheduler.hpp"
+#include "check.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    constexpr uint64_t AllProcessors = ~(uint64_t)0;
+
+    // 2 P-cores with SMT (class 1) on processors 0-3, 4 E-cores (class 0) on processors 4-7
+    const std::vector<Scheduler::CoreInfo> HybridTopology = {
+        { 0x03, 1 },
+        { 0x0C, 1 },
+        { 0x10, 0 },
+        { 0x20, 0 },
+        { 0x40, 0 },
+        { 0x80, 0 },
+    };
+
+    void TestNonHybrid()
+    {
+        // 4 cores with SMT, all the same class
+        const std::vector<Scheduler::CoreInfo> cores = {
+            { 0x03, 0 },
+            { 0x0C, 0 },
+            { 0x30, 0 },
+            { 0xC0, 0 },
+        };
+        CHECK(Scheduler::SelectPerformanceCores(cores, AllProcessors) == 0);
+
+        CHECK(Scheduler::SelectPerformanceCores({}, AllProcessors) == 0);
+    }
+
+    void TestHybrid()
+    {
+        CHECK(Scheduler::SelectPerformanceCores(HybridTopology, AllProcessors) == 0x0F);
+        CHECK(Scheduler::SelectCores(HybridTopology, 0, AllProcessors) == 0xF0);
+
+        // P-cores listed after E-cores
+        const std::vector<Scheduler::CoreInfo> reversed = {
+            { 0x01, 0 },
+            { 0x02, 0 },
+            { 0x0C, 1 },
+            { 0x30, 1 },
+        };
+        CHECK(Scheduler::SelectPerformanceCores(reversed, AllProcessors) == 0x3C);
+
+        // Three efficiency classes: only the highest counts as performance
+        const std::vector<Scheduler::CoreInfo> threeClasses = {
+            { 0x01, 2 },
+            { 0x02, 1 },
+            { 0x04, 1 },
+            { 0x08, 0 },
+        };
+        CHECK(Scheduler::SelectPerformanceCores(threeClasses, AllProcessors) == 0x01);
+    }
+
+    void TestAffinityMask()
+    {
+        // Process restricted to E-cores
+        CHECK(Scheduler::SelectPerformanceCores(HybridTopology, 0xF0) == 0);
+
+        // Process restricted to one P-core and some E-cores
+        CHECK(Scheduler::SelectPerformanceCores(HybridTopology, 0x33) == 0x03);
+    }
+
+    void TestSMT()
+    {
+        // Only one SMT sibling of each P-core allowed
+        CHECK(Scheduler::SelectPerformanceCores(HybridTopology, 0x55) == 0x05);
+
+        // Only the second sibling of the second P-core allowed
+        CHECK(Scheduler::SelectPerformanceCores(HybridTopology, 0x08) == 0x08);
+
+        // High processor indices
+        const std::vector<Scheduler::CoreInfo> cores = {
+            { (uint64_t)0x3 << 62, 1 },
+            { (uint64_t)0x1 << 61, 0 },
+        };
+        CHECK(Scheduler::SelectPerformanceCores(cores, AllProcessors) == (uint64_t)0x3 << 62);
+    }
+
+    void TestCpuSets()
+    {
+        // Windows numbers CPU sets from 0x100
+        std::vector<Scheduler::CpuSetInfo> cpuSets;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            cpuSets.push_back({ 0x100u + i, i });
+        }
+
+        auto ids = Scheduler::SelectCpuSets(cpuSets, 0x0F);
+        CHECK(ids == std::vector<uint32_t>({ 0x100, 0x101, 0x102, 0x103 }));
+
+        ids = Scheduler::SelectCpuSets(cpuSets, 0x05);
+        CHECK(ids == std::vector<uint32_t>({ 0x100, 0x102 }));
+
+        CHECK(Scheduler::SelectCpuSets(cpuSets, 0).empty());
+        CHECK(Scheduler::SelectCpuSets({}, 0x0F).empty());
+    }
+}
+
+int main()
+{
+    TestNonHybrid();
+    TestHybrid();
+    TestAffinityMask();
+    TestSMT();
+    TestCpuSets();
+
+    if (iFailures)
+    {
+        std::printf("%d check(s) failed.\n", iFailures);
+        return 1;
+    }
+    std::printf("All scheduler checks passed.\n");
+    return 0;
+}